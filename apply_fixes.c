@@ -0,0 +1,503 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+  apply_fixes.c
+  - applies every fix for one file in a single linear pass
+  - fixes are edit spans; overlapping spans (e.g. nested sites inside
+    MAKE_U8(CLAMP_U8(COMPLEX_OP(...)))) are reported and skipped,
+    the outermost / earliest span wins
+  - optionally writes a unified diff (REVIEW_DIFF.patch) of the result
+
+  build: cc -O2 -o apply_fixes apply_fixes.c
+  usage: apply_fixes [-o out.c] [-d REVIEW_DIFF.patch] source.c fixes.txt
+
+  fixes.txt, one fix per line ('#' lines and blank lines are ignored):
+    <line>:<col>-<line>:<col><TAB><replacement>
+  lines and columns are 1-based, columns count bytes, the end is exclusive;
+  equal start and end inserts. The replacement understands \n, \t and \\.
+  Identical duplicate fixes are applied once.
+
+  exit status: 0 all fixes applied, 1 some fixes skipped as conflicts,
+               2 usage or input error
+*/
+
+#define DIFF_CONTEXT 3
+
+typedef struct {
+    size_t  start;
+    size_t  end;
+    char   *repl;
+    size_t  repl_len;
+    size_t  fix_line;   /* line in fixes.txt, for messages */
+    size_t  order;      /* input order, keeps the sort stable */
+} fix_t;
+
+typedef struct {
+    char   *data;
+    size_t  len;
+    size_t *line_start; /* offset of each line; line_start[nlines] == len */
+    size_t  nlines;
+} text_t;
+
+/* a run of original lines [first, last] (0-based) rewritten by some fixes */
+typedef struct {
+    size_t  first;
+    size_t  last;
+    size_t  fix_begin;
+    size_t  fix_end;
+} block_t;
+
+typedef struct {
+    char   *data;
+    size_t  len;
+    size_t  cap;
+} buf_t;
+
+static void *xrealloc(void *p, size_t n) {
+    void *q = realloc(p, n);
+    if (q == NULL) {
+        fprintf(stderr, "apply_fixes: out of memory\n");
+        exit(2);
+    }
+    return q;
+}
+
+static void buf_put(buf_t *b, const char *s, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    if (b->len + n > b->cap) {
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap < b->len + n) {
+            cap *= 2;
+        }
+        b->data = xrealloc(b->data, cap);
+        b->cap = cap;
+    }
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+static int read_file(const char *path, char **data, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    buf_t b = { NULL, 0, 0 };
+    char chunk[1 << 16];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        buf_put(&b, chunk, n);
+    }
+    int err = ferror(f);
+    fclose(f);
+    if (err) {
+        fprintf(stderr, "apply_fixes: %s: read error\n", path);
+        free(b.data);
+        return -1;
+    }
+    buf_put(&b, "", 1); /* NUL terminator, not counted */
+    *data = b.data;
+    *len = b.len - 1;
+    return 0;
+}
+
+static void index_lines(text_t *t) {
+    size_t cap = 1024;
+    t->line_start = xrealloc(NULL, cap * sizeof(size_t));
+    t->nlines = 0;
+    t->line_start[0] = 0;
+    for (size_t i = 0; i < t->len; ++i) {
+        if (t->data[i] == '\n' && i + 1 < t->len) {
+            if (t->nlines + 2 >= cap) {
+                cap *= 2;
+                t->line_start = xrealloc(t->line_start, cap * sizeof(size_t));
+            }
+            t->line_start[++t->nlines] = i + 1;
+        }
+    }
+    if (t->len > 0) {
+        t->nlines++;
+    }
+    t->line_start[t->nlines] = t->len;
+}
+
+/* 0-based line containing byte offset off */
+static size_t line_of(const text_t *t, size_t off) {
+    size_t lo = 0;
+    size_t hi = t->nlines;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (t->line_start[mid] <= off) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int to_offset(const text_t *t, unsigned long line, unsigned long col, size_t *off) {
+    if (line == 0 || col == 0) {
+        return -1;
+    }
+    if (line == t->nlines + 1 && col == 1) {
+        *off = t->len; /* append at end of file */
+        return 0;
+    }
+    if (line > t->nlines) {
+        return -1;
+    }
+    size_t start = t->line_start[line - 1];
+    size_t end = t->line_start[line];
+    if (col - 1 > end - start) {
+        return -1;
+    }
+    *off = start + (col - 1);
+    return 0;
+}
+
+static size_t unescape(char *s) {
+    char *w = s;
+    for (char *r = s; *r != '\0'; ++r) {
+        if (*r == '\\' && r[1] != '\0') {
+            ++r;
+            *w++ = (*r == 'n') ? '\n' : (*r == 't') ? '\t' : *r;
+        } else {
+            *w++ = *r;
+        }
+    }
+    *w = '\0';
+    return (size_t)(w - s);
+}
+
+static int parse_fixes(const text_t *t, char *data, fix_t **out, size_t *count) {
+    size_t cap = 64;
+    size_t n = 0;
+    fix_t *fixes = xrealloc(NULL, cap * sizeof(fix_t));
+    size_t lineno = 0;
+
+    for (char *line = data; line != NULL && *line != '\0';) {
+        char *next = strchr(line, '\n');
+        if (next != NULL) {
+            *next++ = '\0';
+        }
+        lineno++;
+        size_t l = strlen(line);
+        if (l > 0 && line[l - 1] == '\r') {
+            line[--l] = '\0';
+        }
+        if (l == 0 || line[0] == '#') {
+            line = next;
+            continue;
+        }
+
+        unsigned long sl, sc, el, ec;
+        int used = 0;
+        if (sscanf(line, "%lu:%lu-%lu:%lu%n", &sl, &sc, &el, &ec, &used) != 4 ||
+            line[used] != '\t') {
+            fprintf(stderr, "apply_fixes: fixes:%zu: expected '<line>:<col>-<line>:<col>"
+                    "<TAB><replacement>'\n", lineno);
+            free(fixes);
+            return -1;
+        }
+        fix_t f;
+        memset(&f, 0, sizeof(f));
+        if (to_offset(t, sl, sc, &f.start) != 0 || to_offset(t, el, ec, &f.end) != 0 ||
+            f.end < f.start) {
+            fprintf(stderr, "apply_fixes: fixes:%zu: span %lu:%lu-%lu:%lu is outside the"
+                    " source\n", lineno, sl, sc, el, ec);
+            free(fixes);
+            return -1;
+        }
+        f.repl = line + used + 1;
+        f.repl_len = unescape(f.repl);
+        f.fix_line = lineno;
+        f.order = n;
+        if (n == cap) {
+            cap *= 2;
+            fixes = xrealloc(fixes, cap * sizeof(fix_t));
+        }
+        fixes[n++] = f;
+        line = next;
+    }
+    *out = fixes;
+    *count = n;
+    return 0;
+}
+
+/* by start; for equal starts the wider (outer) span first */
+static int cmp_fix(const void *pa, const void *pb) {
+    const fix_t *a = pa;
+    const fix_t *b = pb;
+    if (a->start != b->start) {
+        return a->start < b->start ? -1 : 1;
+    }
+    if (a->end != b->end) {
+        return a->end > b->end ? -1 : 1;
+    }
+    return a->order < b->order ? -1 : (a->order > b->order);
+}
+
+static int same_fix(const fix_t *a, const fix_t *b) {
+    return a->start == b->start && a->end == b->end && a->repl_len == b->repl_len &&
+           memcmp(a->repl, b->repl, a->repl_len) == 0;
+}
+
+/* drops duplicates and conflicting spans in place; returns the number of conflicts */
+static size_t resolve_conflicts(const text_t *t, fix_t *fixes, size_t *count) {
+    size_t kept = 0;
+    size_t conflicts = 0;
+    for (size_t i = 0; i < *count; ++i) {
+        fix_t *f = &fixes[i];
+        if (kept > 0) {
+            fix_t *prev = &fixes[kept - 1];
+            if (same_fix(prev, f)) {
+                continue;
+            }
+            int overlap = f->start < prev->end ||
+                          (f->start == prev->start && (f->start == f->end ||
+                                                       prev->start == prev->end));
+            if (overlap) {
+                fprintf(stderr, "apply_fixes: fixes:%zu: conflicts with fixes:%zu at"
+                        " line %zu, skipped\n", f->fix_line, prev->fix_line,
+                        line_of(t, f->start) + 1);
+                conflicts++;
+                continue;
+            }
+        }
+        fixes[kept++] = *f;
+    }
+    *count = kept;
+    return conflicts;
+}
+
+/* copies src[from, to) into out with the fixes in [fb, fe) applied */
+static void apply_range(buf_t *out, const char *src, size_t from, size_t to,
+                        const fix_t *fixes, size_t fb, size_t fe) {
+    size_t pos = from;
+    for (size_t i = fb; i < fe; ++i) {
+        buf_put(out, src + pos, fixes[i].start - pos);
+        buf_put(out, fixes[i].repl, fixes[i].repl_len);
+        pos = fixes[i].end;
+    }
+    buf_put(out, src + pos, to - pos);
+}
+
+static size_t build_blocks(const text_t *t, const fix_t *fixes, size_t count,
+                           block_t **out) {
+    block_t *blocks = xrealloc(NULL, (count ? count : 1) * sizeof(block_t));
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t first = line_of(t, fixes[i].start);
+        size_t last = fixes[i].end > fixes[i].start ? line_of(t, fixes[i].end - 1) : first;
+        /* a span that eats a newline joins the next line into this block */
+        if (fixes[i].end > fixes[i].start && fixes[i].end < t->len &&
+            t->data[fixes[i].end - 1] == '\n') {
+            last = line_of(t, fixes[i].end);
+        }
+        if (fixes[i].start == t->len && t->nlines > 0) {
+            first = last = t->nlines - 1;
+        }
+        if (n > 0 && first <= blocks[n - 1].last) {
+            if (last > blocks[n - 1].last) {
+                blocks[n - 1].last = last;
+            }
+            blocks[n - 1].fix_end = i + 1;
+            continue;
+        }
+        blocks[n].first = first;
+        blocks[n].last = last;
+        blocks[n].fix_begin = i;
+        blocks[n].fix_end = i + 1;
+        n++;
+    }
+    *out = blocks;
+    return n;
+}
+
+static size_t count_lines(const char *s, size_t len) {
+    size_t lines = 0;
+    for (size_t i = 0; i < len; ++i) {
+        lines += (s[i] == '\n');
+    }
+    return lines + (len > 0 && s[len - 1] != '\n');
+}
+
+/* writes s as diff lines prefixed with c */
+static void put_diff_lines(FILE *f, char c, const char *s, size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+        const char *nl = memchr(s + pos, '\n', len - pos);
+        size_t end = nl ? (size_t)(nl - s) : len;
+        fputc(c, f);
+        fwrite(s + pos, 1, end - pos, f);
+        fputc('\n', f);
+        if (nl == NULL) {
+            fputs("\\ No newline at end of file\n", f);
+        }
+        pos = end + 1;
+    }
+}
+
+static int write_diff(const char *path, const char *name, const text_t *t,
+                      const fix_t *fixes, const block_t *blocks, size_t nblocks) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    buf_t repl = { NULL, 0, 0 };
+    if (t->nlines == 0) {
+        /* empty source: every fix is an insertion at offset 0, one hunk of added lines */
+        if (nblocks > 0) {
+            apply_range(&repl, t->data, 0, 0, fixes, blocks[0].fix_begin,
+                        blocks[nblocks - 1].fix_end);
+        }
+        if (repl.len > 0) {
+            fprintf(f, "--- a/%s\n+++ b/%s\n", name, name);
+            fprintf(f, "@@ -0,0 +1,%zu @@\n", count_lines(repl.data, repl.len));
+            put_diff_lines(f, '+', repl.data, repl.len);
+        }
+        nblocks = 0;
+    } else if (nblocks > 0) {
+        fprintf(f, "--- a/%s\n+++ b/%s\n", name, name);
+    }
+
+    long delta = 0; /* new line numbers minus old, before the current hunk */
+    for (size_t h = 0; h < nblocks;) {
+        size_t e = h + 1;
+        while (e < nblocks && blocks[e].first - blocks[e - 1].last <= 2 * DIFF_CONTEXT + 1) {
+            e++;
+        }
+        size_t from = blocks[h].first > DIFF_CONTEXT ? blocks[h].first - DIFF_CONTEXT : 0;
+        size_t to = blocks[e - 1].last + DIFF_CONTEXT;
+        if (to >= t->nlines) {
+            to = t->nlines - 1;
+        }
+
+        /* new line count of the hunk */
+        size_t old_count = to - from + 1;
+        size_t new_count = old_count;
+        for (size_t b = h; b < e; ++b) {
+            size_t lo = t->line_start[blocks[b].first];
+            size_t hi = t->line_start[blocks[b].last + 1];
+            repl.len = 0;
+            apply_range(&repl, t->data, lo, hi, fixes, blocks[b].fix_begin, blocks[b].fix_end);
+            new_count = new_count - (blocks[b].last - blocks[b].first + 1) +
+                        count_lines(repl.data, repl.len);
+        }
+        fprintf(f, "@@ -%zu,%zu +%ld,%zu @@\n", from + 1, old_count,
+                (long)(from + 1) + delta - (new_count == 0), new_count);
+
+        size_t line = from;
+        for (size_t b = h; b < e; ++b) {
+            size_t lo = t->line_start[blocks[b].first];
+            size_t hi = t->line_start[blocks[b].last + 1];
+            put_diff_lines(f, ' ', t->data + t->line_start[line], lo - t->line_start[line]);
+            put_diff_lines(f, '-', t->data + lo, hi - lo);
+            repl.len = 0;
+            apply_range(&repl, t->data, lo, hi, fixes, blocks[b].fix_begin, blocks[b].fix_end);
+            put_diff_lines(f, '+', repl.data, repl.len);
+            line = blocks[b].last + 1;
+        }
+        put_diff_lines(f, ' ', t->data + t->line_start[line],
+                       t->line_start[to + 1] - t->line_start[line]);
+
+        delta += (long)new_count - (long)old_count;
+        h = e;
+    }
+    free(repl.data);
+    if (fclose(f) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-o out.c] [-d REVIEW_DIFF.patch] source.c fixes.txt\n",
+            argv0);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = NULL;
+    const char *diff_path = NULL;
+    const char *src_path = NULL;
+    const char *fixes_path = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            diff_path = argv[++i];
+        } else if (src_path == NULL) {
+            src_path = argv[i];
+        } else if (fixes_path == NULL) {
+            fixes_path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (src_path == NULL || fixes_path == NULL) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    text_t src;
+    char *fix_data = NULL;
+    size_t fix_len = 0;
+    if (read_file(src_path, &src.data, &src.len) != 0 ||
+        read_file(fixes_path, &fix_data, &fix_len) != 0) {
+        return 2;
+    }
+    index_lines(&src);
+
+    fix_t *fixes = NULL;
+    size_t count = 0;
+    if (parse_fixes(&src, fix_data, &fixes, &count) != 0) {
+        return 2;
+    }
+    qsort(fixes, count, sizeof(fix_t), cmp_fix);
+    size_t requested = count;
+    size_t conflicts = resolve_conflicts(&src, fixes, &count);
+
+    buf_t out = { NULL, 0, 0 };
+    apply_range(&out, src.data, 0, src.len, fixes, 0, count);
+
+    int rc = conflicts ? 1 : 0;
+    if (diff_path != NULL) {
+        block_t *blocks = NULL;
+        size_t nblocks = build_blocks(&src, fixes, count, &blocks);
+        if (write_diff(diff_path, src_path, &src, fixes, blocks, nblocks) != 0) {
+            rc = 2;
+        }
+        free(blocks);
+    }
+
+    FILE *f = out_path ? fopen(out_path, "wb") : stdout;
+    if (f == NULL) {
+        perror(out_path);
+        return 2;
+    }
+    if (fwrite(out.data, 1, out.len, f) != out.len || (out_path && fclose(f) != 0)) {
+        perror(out_path ? out_path : "stdout");
+        return 2;
+    }
+    fprintf(stderr, "apply_fixes: %s: %zu fixes, %zu applied, %zu conflicts\n", src_path,
+            requested, count, conflicts);
+
+    free(out.data);
+    free(fixes);
+    free(fix_data);
+    free(src.line_start);
+    free(src.data);
+    return rc;
+}
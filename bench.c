@@ -0,0 +1,412 @@
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/*
+  bench.c
+  - throughput harness for the fixer/analyzer
+  - runs the analyzer command on example.c and on gen_corpus outputs
+  - records wall time, lines/sec, peak RSS, per-phase timings and the
+    precision/recall of the findings into bench_output.txt, one
+    "key=value" record per input
+
+  build: cc -O2 -o bench bench.c
+  usage: bench [-o bench_output.txt] [-g ./gen_corpus] [-d bench_corpus]
+               [-n 10K,100K,1M] [-i example.c] [-S ./score]
+               [-p min_precision] [-r min_recall] -- analyzer [args...]
+         the input path is appended as the analyzer's last argument
+
+  findings: the analyzer's stdout ("path:line" per finding, with the path
+  as given on its command line) is saved as <dir>/<n>_<input>.findings and
+  scored against the input's unsigned不一致 markers with score, whose
+  report goes next to it as .score. -p/-r are passed on to score and a
+  run below them makes bench exit 1. -S "" skips scoring; records then
+  carry precision=- recall=-.
+
+  phase timings: the analyzer reports them on stderr as lines of the form
+    "phase <name> <seconds>"
+  with <name> one of preprocess, macro_expand, typedef_resolve,
+  mismatch_detect; phases that are not reported are written as "-".
+  All other stderr output is passed through unchanged.
+*/
+
+#define BENCH_FORMAT 2
+#define MAX_INPUTS 32
+
+static const char *const phase_names[] = {
+    "preprocess",
+    "macro_expand",
+    "typedef_resolve",
+    "mismatch_detect",
+};
+
+#define NPHASES (sizeof(phase_names) / sizeof(phase_names[0]))
+
+typedef struct {
+    const char *path;
+    uint64_t    lines;
+    double      wall_s;
+    long        peak_rss_kb;
+    int         status;
+    int         have_phase[NPHASES];
+    double      phase_s[NPHASES];
+    int         scored;
+    double      precision;
+    double      recall;
+} run_t;
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int count_lines(const char *path, uint64_t *out) {
+    char buf[1 << 16];
+    size_t n;
+    uint64_t lines = 0;
+    char last = '\n';
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return -1;
+    }
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            lines += (buf[i] == '\n');
+        }
+        last = buf[n - 1];
+    }
+    fclose(f);
+    *out = lines + (last != '\n'); /* unterminated last line, as in example.c */
+    return 0;
+}
+
+static void parse_phase(run_t *run, const char *line) {
+    char name[64];
+    double secs;
+    if (sscanf(line, "phase %63s %lf", name, &secs) != 2) {
+        fputs(line, stderr);
+        return;
+    }
+    for (size_t i = 0; i < NPHASES; ++i) {
+        if (strcmp(name, phase_names[i]) == 0) {
+            run->phase_s[i] += secs;
+            run->have_phase[i] = 1;
+            return;
+        }
+    }
+    fputs(line, stderr);
+}
+
+/*
+  runs argv (NULL-terminated) and fills wall time, peak RSS and phases;
+  stdout goes to out_path when it is not NULL
+*/
+static int run_child(char **argv, const char *out_path, run_t *run) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return -1;
+    }
+    double start = now_s();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        dup2(fds[1], STDERR_FILENO);
+        close(fds[1]);
+        if (out_path != NULL) {
+            int fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            if (fd < 0) {
+                fprintf(stderr, "bench: %s: %s\n", out_path, strerror(errno));
+                _exit(127);
+            }
+            dup2(fd, STDOUT_FILENO);
+            close(fd);
+        }
+        execvp(argv[0], argv);
+        fprintf(stderr, "bench: exec %s: %s\n", argv[0], strerror(errno));
+        _exit(127);
+    }
+    close(fds[1]);
+
+    FILE *err = fdopen(fds[0], "r");
+    char line[1024];
+    while (err != NULL && fgets(line, sizeof(line), err) != NULL) {
+        parse_phase(run, line);
+    }
+    if (err != NULL) {
+        fclose(err);
+    } else {
+        close(fds[0]);
+    }
+
+    int status = 0;
+    struct rusage ru;
+    memset(&ru, 0, sizeof(ru));
+    while (wait4(pid, &status, 0, &ru) < 0) {
+        if (errno != EINTR) {
+            perror("wait4");
+            return -1;
+        }
+    }
+    run->wall_s = now_s() - start;
+#ifdef __APPLE__
+    run->peak_rss_kb = ru.ru_maxrss / 1024; /* bytes on macOS, KiB elsewhere */
+#else
+    run->peak_rss_kb = ru.ru_maxrss;
+#endif
+    run->status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    return 0;
+}
+
+/*
+  corpora are generated under temporary names and renamed into place once
+  gen_corpus succeeds, so an existing corpus_<size>.c is always complete
+*/
+static int ensure_corpus(const char *gen, const char *dir, const char *size, char *path,
+                         size_t len) {
+    struct stat st;
+    char tmp[4000];  /* leaves room for the ".manifest" suffix below */
+    char manifest[4096];
+    char tmp_manifest[4096];
+    snprintf(path, len, "%s/corpus_%s.c", dir, size);
+    snprintf(manifest, sizeof(manifest), "%s.manifest", path);
+    if (stat(path, &st) == 0 && stat(manifest, &st) == 0) {
+        return 0; /* same size and default seed: reuse the previous corpus */
+    }
+    snprintf(tmp, sizeof(tmp), "%s/.corpus_%s.%ld.c", dir, size, (long)getpid());
+    snprintf(tmp_manifest, sizeof(tmp_manifest), "%s.manifest", tmp);
+
+    char *argv[] = { (char *)gen, "-n", (char *)size, "-o", tmp, "-m", tmp_manifest,
+                     "-N", path, NULL };
+    run_t run;
+    memset(&run, 0, sizeof(run));
+    if (run_child(argv, NULL, &run) != 0 || run.status != 0) {
+        fprintf(stderr, "bench: %s failed for size %s\n", gen, size);
+        remove(tmp);
+        remove(tmp_manifest);
+        return -1;
+    }
+    if (rename(tmp_manifest, manifest) != 0 || rename(tmp, path) != 0) {
+        fprintf(stderr, "bench: %s: %s\n", path, strerror(errno));
+        remove(tmp);
+        remove(tmp_manifest);
+        return -1;
+    }
+    return 0;
+}
+
+/*
+  scores the findings of one run; returns 1 when score reports a result
+  below -p/-r, 0 otherwise, and -1 when scoring itself failed
+*/
+static int score_run(const char *score, const char *min_p, const char *min_r,
+                     const char *findings, const char *report, run_t *run) {
+    char *argv[12];
+    int n = 0;
+    argv[n++] = (char *)score;
+    argv[n++] = "-o";
+    argv[n++] = (char *)report;
+    if (min_p != NULL) {
+        argv[n++] = "-p";
+        argv[n++] = (char *)min_p;
+    }
+    if (min_r != NULL) {
+        argv[n++] = "-r";
+        argv[n++] = (char *)min_r;
+    }
+    argv[n++] = (char *)findings;
+    argv[n++] = (char *)run->path;
+    argv[n] = NULL;
+
+    run_t sr;
+    memset(&sr, 0, sizeof(sr));
+    if (run_child(argv, NULL, &sr) != 0 || (sr.status != 0 && sr.status != 1)) {
+        fprintf(stderr, "bench: %s failed on %s\n", score, findings);
+        return -1;
+    }
+
+    FILE *f = fopen(report, "r");
+    char line[1024];
+    while (f != NULL && fgets(line, sizeof(line), f) != NULL) {
+        const char *p = strstr(line, " precision=");
+        const char *r = strstr(line, " recall=");
+        if (strncmp(line, "total=", 6) == 0 && p != NULL && r != NULL) {
+            run->precision = strtod(p + 11, NULL);
+            run->recall = strtod(r + 8, NULL);
+            run->scored = 1;
+        }
+    }
+    if (f != NULL) {
+        fclose(f);
+    }
+    if (!run->scored) {
+        fprintf(stderr, "bench: %s: no total score\n", report);
+        return -1;
+    }
+    return sr.status;
+}
+
+static void write_record(FILE *out, const run_t *run) {
+    double lps = run->wall_s > 0.0 ? (double)run->lines / run->wall_s : 0.0;
+    fprintf(out, "input=%s lines=%" PRIu64 " status=%d wall_s=%.6f lines_per_s=%.0f"
+            " peak_rss_kb=%ld", run->path, run->lines, run->status, run->wall_s, lps,
+            run->peak_rss_kb);
+    for (size_t i = 0; i < NPHASES; ++i) {
+        if (run->have_phase[i]) {
+            fprintf(out, " %s_s=%.6f", phase_names[i], run->phase_s[i]);
+        } else {
+            fprintf(out, " %s_s=-", phase_names[i]);
+        }
+    }
+    if (run->scored) {
+        fprintf(out, " precision=%.4f recall=%.4f", run->precision, run->recall);
+    } else {
+        fputs(" precision=- recall=-", out);
+    }
+    fputc('\n', out);
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-o out] [-g gen_corpus] [-d dir] [-n sizes] [-i input]"
+            " [-S score] [-p min] [-r min] -- analyzer [args...]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = "bench_output.txt";
+    const char *gen = "./gen_corpus";
+    const char *dir = "bench_corpus";
+    const char *score = "./score";
+    const char *min_p = NULL;
+    const char *min_r = NULL;
+    char sizes[256] = "10K,100K,1M";
+    const char *inputs[MAX_INPUTS];
+    int ninputs = 0;
+    int cmd = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--") == 0) {
+            cmd = i + 1;
+            break;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            gen = argv[++i];
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            dir = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            snprintf(sizes, sizeof(sizes), "%s", argv[++i]);
+        } else if (strcmp(argv[i], "-S") == 0 && i + 1 < argc) {
+            score = argv[++i];
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            min_p = argv[++i];
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            min_r = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc && ninputs < MAX_INPUTS) {
+            inputs[ninputs++] = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (cmd < 0 || cmd >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (ninputs == 0) {
+        inputs[ninputs++] = "example.c";
+    }
+
+    /* dir also holds the findings and score reports */
+    if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+        perror(dir);
+        return 1;
+    }
+
+    /* generated corpora; an empty -n list benchmarks only the -i inputs */
+    static char corpus_paths[MAX_INPUTS][4096];
+    if (sizes[0] != '\0') {
+        for (char *tok = strtok(sizes, ","); tok != NULL && ninputs < MAX_INPUTS;
+             tok = strtok(NULL, ",")) {
+            char *path = corpus_paths[ninputs];
+            if (ensure_corpus(gen, dir, tok, path, sizeof(corpus_paths[0])) != 0) {
+                return 1;
+            }
+            inputs[ninputs++] = path;
+        }
+    }
+
+    FILE *out = fopen(out_path, "w");
+    if (out == NULL) {
+        perror(out_path);
+        return 1;
+    }
+    fprintf(out, "# bench format=%d analyzer=%s\n", BENCH_FORMAT, argv[cmd]);
+
+    int nargs = argc - cmd;
+    char **child = calloc((size_t)nargs + 2, sizeof(char *));
+    if (child == NULL) {
+        perror("calloc");
+        fclose(out);
+        return 1;
+    }
+    memcpy(child, &argv[cmd], (size_t)nargs * sizeof(char *));
+
+    int rc = 0;
+    for (int i = 0; i < ninputs; ++i) {
+        run_t run;
+        memset(&run, 0, sizeof(run));
+        run.path = inputs[i];
+        if (count_lines(inputs[i], &run.lines) != 0) {
+            perror(inputs[i]);
+            rc = 1;
+            continue;
+        }
+        char findings[4096];
+        char report[4096];
+        const char *base = strrchr(inputs[i], '/');
+        base = base ? base + 1 : inputs[i];
+        snprintf(findings, sizeof(findings), "%s/%d_%s.findings", dir, i, base);
+        snprintf(report, sizeof(report), "%s/%d_%s.score", dir, i, base);
+
+        child[nargs] = (char *)inputs[i];
+        if (run_child(child, findings, &run) != 0) {
+            rc = 1;
+            continue;
+        }
+        if (score[0] != '\0' && score_run(score, min_p, min_r, findings, report, &run) != 0) {
+            rc = 1;
+        }
+        write_record(out, &run);
+        fflush(out);
+        if (run.status != 0) {
+            rc = 1;
+        }
+    }
+
+    free(child);
+    if (fclose(out) != 0) {
+        perror(out_path);
+        rc = 1;
+    }
+    return rc;
+}
@@ -0,0 +1,289 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+  bench_kernels.c
+  - micro-benchmarks of example.c's helper kernels in their original form
+    and in a hand-written explicit-cast rewrite: make_mod,
+    mix_signed_unsigned, CLAMP_U8 saturation and the scenario 18 node_t
+    update loop (array-of-structs and a struct-of-arrays variant)
+  - the rewrites are written here by hand to stand in for fixer output;
+    they are not produced by any tool in this tree
+  - each pair must produce identical output (a checksum over every array
+    the kernels write), so a delta is purely the cost of the casts
+  - appends one "key=value" record per variant and one delta record per
+    kernel to bench_output.txt (after bench's records when both are run)
+
+  build: cc -O3 -o bench_kernels bench_kernels.c
+         add -fopt-info-vec-missed (gcc) to see which loops stopped vectorizing
+  usage: bench_kernels [-o bench_output.txt] [-n elements] [-r repeats]
+*/
+
+typedef uint8_t  u8;
+typedef uint32_t u32;
+typedef int8_t   i8;
+typedef int16_t  i16;
+typedef int32_t  i32;
+typedef uint16_t u16;
+
+/* original fixture macro */
+#define CLAMP_U8(x) ((u8)(((x) > 255) ? 255 : (((x) < 0) ? 0 : (x))))
+
+/* hand-written rewrite: one evaluation, comparisons done in i32 */
+#define CLAMP_U8_REWRITE(x) clamp_u8_rewrite((i32)(x))
+
+static inline u8 clamp_u8_rewrite(i32 x) {
+    return (u8)(x > 255 ? 255 : (x < 0 ? 0 : x));
+}
+
+typedef struct {
+    u8   a;
+    i8   b;
+    u16  c;
+    i16  d;
+} node_t;
+
+typedef struct {
+    size_t  n;
+    u8     *ua;
+    i8     *ib;
+    u8     *out;
+    node_t *nodes;
+    u8     *soa_a;  /* node_t.a / node_t.b split out for the SoA variant */
+    i8     *soa_b;
+} data_t;
+
+typedef void (*kernel_fn)(data_t *d);
+
+/* make_mod: (u8)((a + b + 4) % 256) */
+static void make_mod_original(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        u8 a = d->ua[i];
+        u8 b = d->out[i];
+        d->out[i] = (u8)((a + b + 4) % 256);
+    }
+}
+
+static void make_mod_rewrite(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        u8 a = d->ua[i];
+        u8 b = d->out[i];
+        d->out[i] = (u8)(((u32)a + (u32)b + 4u) % 256u);
+    }
+}
+
+/* mix_signed_unsigned: i32 tmp = (i32)ua + (i32)ib; return (u8)tmp */
+static void mix_original(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        i32 tmp = (i32)d->ua[i] + (i32)d->ib[i];
+        d->out[i] = (u8)tmp;
+    }
+}
+
+static void mix_rewrite(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        u32 tmp = (u32)d->ua[i] + (u32)(i32)d->ib[i];
+        d->out[i] = (u8)(tmp & 0xFFu);
+    }
+}
+
+/* scenario 3: CLAMP_U8((int)ua + (int)ib) */
+static void clamp_original(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        d->out[i] = CLAMP_U8((int)d->ua[i] + (int)d->ib[i]);
+    }
+}
+
+static void clamp_rewrite(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        d->out[i] = CLAMP_U8_REWRITE((i32)d->ua[i] + (i32)d->ib[i]);
+    }
+}
+
+/* scenario 18: NODE_SET_A / NODE_SET_B then mix over node_t[] */
+static void nodes_original(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        d->nodes[i].a = (u8)(i * 25);
+        d->nodes[i].b = (i8)(i - 7);
+        d->nodes[i].a = (u8)((i32)d->nodes[i].a + (i32)d->nodes[i].b);
+    }
+}
+
+static void nodes_rewrite(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        d->nodes[i].a = (u8)((u32)i * 25u);
+        d->nodes[i].b = (i8)(u8)((u32)i - 7u);
+        d->nodes[i].a = (u8)((u32)d->nodes[i].a + (u32)(i32)d->nodes[i].b);
+    }
+}
+
+static void nodes_soa_original(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        d->soa_a[i] = (u8)(i * 25);
+        d->soa_b[i] = (i8)(i - 7);
+        d->soa_a[i] = (u8)((i32)d->soa_a[i] + (i32)d->soa_b[i]);
+    }
+}
+
+static void nodes_soa_rewrite(data_t *d) {
+    for (size_t i = 0; i < d->n; ++i) {
+        d->soa_a[i] = (u8)((u32)i * 25u);
+        d->soa_b[i] = (i8)(u8)((u32)i - 7u);
+        d->soa_a[i] = (u8)((u32)d->soa_a[i] + (u32)(i32)d->soa_b[i]);
+    }
+}
+
+typedef struct {
+    const char *name;
+    kernel_fn   original;
+    kernel_fn   rewrite;
+} kernel_t;
+
+static const kernel_t kernels[] = {
+    { "make_mod",            make_mod_original,  make_mod_rewrite },
+    { "mix_signed_unsigned", mix_original,       mix_rewrite },
+    { "clamp_u8",            clamp_original,     clamp_rewrite },
+    { "node_update_aos",     nodes_original,     nodes_rewrite },
+    { "node_update_soa",     nodes_soa_original, nodes_soa_rewrite },
+};
+
+#define NKERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/* inputs are reset before every run so make_mod's in-place update is repeatable */
+static void reset(data_t *d) {
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < d->n; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        d->ua[i] = (u8)x;
+        d->ib[i] = (i8)(u8)(x >> 8);
+        d->out[i] = (u8)(x >> 16);
+    }
+    memset(d->nodes, 0, d->n * sizeof(node_t));
+    memset(d->soa_a, 0, d->n);
+    memset(d->soa_b, 0, d->n);
+}
+
+static uint64_t checksum(const data_t *d) {
+    uint64_t h = 1469598103934665603ULL; /* FNV-1a */
+    for (size_t i = 0; i < d->n; ++i) {
+        h = (h ^ d->out[i]) * 1099511628211ULL;
+        h = (h ^ d->nodes[i].a) * 1099511628211ULL;
+        h = (h ^ (u8)d->nodes[i].b) * 1099511628211ULL;
+        h = (h ^ d->nodes[i].c) * 1099511628211ULL;
+        h = (h ^ (u16)d->nodes[i].d) * 1099511628211ULL;
+        h = (h ^ d->soa_a[i]) * 1099511628211ULL;
+        h = (h ^ (u8)d->soa_b[i]) * 1099511628211ULL;
+    }
+    return h;
+}
+
+/* best-of-repeats time per element; the checksum is taken from the last run */
+static double time_kernel(kernel_fn fn, data_t *d, int repeats, uint64_t *sum) {
+    double best = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        reset(d);
+        double start = now_ns();
+        fn(d);
+        double ns = (now_ns() - start) / (double)d->n;
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    *sum = checksum(d);
+    return best;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-o bench_output.txt] [-n elements] [-r repeats]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = "bench_output.txt";
+    size_t n = (size_t)1 << 20;
+    int repeats = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            n = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            repeats = atoi(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (n == 0 || repeats <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    data_t d;
+    d.n = n;
+    d.ua = malloc(n);
+    d.ib = malloc(n);
+    d.out = malloc(n);
+    d.nodes = malloc(n * sizeof(node_t));
+    d.soa_a = malloc(n);
+    d.soa_b = malloc(n);
+    if (!d.ua || !d.ib || !d.out || !d.nodes || !d.soa_a || !d.soa_b) {
+        fprintf(stderr, "bench_kernels: out of memory for %zu elements\n", n);
+        return 1;
+    }
+
+    FILE *out = fopen(out_path, "a");
+    if (out == NULL) {
+        perror(out_path);
+        return 1;
+    }
+    fprintf(out, "# bench_kernels format=1 elements=%zu repeats=%d\n", n, repeats);
+
+    int rc = 0;
+    for (size_t k = 0; k < NKERNELS; ++k) {
+        uint64_t sum_o = 0;
+        uint64_t sum_f = 0;
+        double ns_o = time_kernel(kernels[k].original, &d, repeats, &sum_o);
+        double ns_f = time_kernel(kernels[k].rewrite, &d, repeats, &sum_f);
+        double delta = ns_o > 0.0 ? (ns_f - ns_o) / ns_o * 100.0 : 0.0;
+        int match = sum_o == sum_f;
+
+        fprintf(out, "kernel=%s variant=original ns_per_elem=%.4f checksum=%016" PRIx64 "\n",
+                kernels[k].name, ns_o, sum_o);
+        fprintf(out, "kernel=%s variant=rewrite ns_per_elem=%.4f checksum=%016" PRIx64 "\n",
+                kernels[k].name, ns_f, sum_f);
+        fprintf(out, "kernel=%s delta_pct=%+.1f match=%s\n", kernels[k].name, delta,
+                match ? "yes" : "no");
+        fprintf(stderr, "%-20s original %.4f ns  rewrite %.4f ns  delta %+.1f%%%s\n",
+                kernels[k].name, ns_o, ns_f, delta, match ? "" : "  OUTPUT DIFFERS");
+        if (!match) {
+            rc = 1;
+        }
+    }
+
+    if (fclose(out) != 0) {
+        perror(out_path);
+        rc = 1;
+    }
+    free(d.ua);
+    free(d.ib);
+    free(d.out);
+    free(d.nodes);
+    free(d.soa_a);
+    free(d.soa_b);
+    return rc;
+}
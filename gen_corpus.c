@@ -0,0 +1,438 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+  gen_corpus.c
+  - synthetic translation-unit generator for throughput runs of the fixer/analyzer
+  - replays the 21 numbered scenario blocks of example.c's main in seeded order
+  - writes a ground-truth manifest with one "path:line:scenario" entry per
+    expected unsigned/signed mismatch (the lines tagged "unsigned不一致")
+
+  build: cc -O2 -o gen_corpus gen_corpus.c
+  usage: gen_corpus [-n lines] [-s seed] [-o out.c] [-m manifest.txt] [-N name]
+         lines accepts a K/M suffix (e.g. -n 10K, -n 10M); default 10K
+         name is the path recorded in the manifest (default: out.c), for
+         writing under a temporary name and renaming into place
+*/
+
+#define MARK " /* unsigned不一致 */"
+
+/* one template line; site != 0 means the line is an expected finding */
+typedef struct {
+    const char *text;
+    int         site;
+} tline_t;
+
+typedef struct {
+    const char    *id;
+    const tline_t *lines;
+    size_t         count;
+} scenario_t;
+
+typedef struct {
+    FILE         *out;
+    FILE         *manifest;
+    const char   *path;
+    uint64_t      line;
+    uint64_t      sites;
+    uint64_t      rng;
+} gen_t;
+
+/* prelude: the typedefs, macros, struct and helpers from example.c */
+static const tline_t prelude[] = {
+    { "#include <stdio.h>", 0 },
+    { "#include <stdint.h>", 0 },
+    { "#include <inttypes.h>", 0 },
+    { "#include <stdlib.h>", 0 },
+    { "#include <string.h>", 0 },
+    { "", 0 },
+    { "/* generated by gen_corpus from example.c scenarios */", 0 },
+    { "", 0 },
+    { "typedef uint8_t  u8;", 0 },
+    { "typedef uint16_t u16;", 0 },
+    { "typedef uint32_t u32;", 0 },
+    { "typedef uint64_t u64;", 0 },
+    { "typedef int8_t   i8;", 0 },
+    { "typedef int16_t  i16;", 0 },
+    { "typedef int32_t  i32;", 0 },
+    { "typedef int64_t  i64;", 0 },
+    { "typedef u8  byte_t;", 0 },
+    { "typedef u8  small_t;", 0 },
+    { "typedef i8  sbyte_t;", 0 },
+    { "typedef u16 word_t;", 0 },
+    { "typedef i16 sword_t;", 0 },
+    { "", 0 },
+    { "#define MAKE_U8(x) ((u8)(x))", 0 },
+    { "#define MAKE_I8(x) ((i8)(x))", 0 },
+    { "#define TO_U32(x)  ((u32)(x))", 0 },
+    { "#define TO_I32(x)  ((i32)(x))", 0 },
+    { "#define MUL(a,b)   ((a)*(b))", 0 },
+    { "#define ADD(a,b)   ((a)+(b))", 0 },
+    { "#define SUB(a,b)   ((a)-(b))", 0 },
+    { "#define TYPDEF_ALIAS(name, base) typedef base name", 0 },
+    { "TYPDEF_ALIAS(my_u8_t, uint8_t);", 0 },
+    { "TYPDEF_ALIAS(my_i8_t, int8_t);", 0 },
+    { "#define CLAMP_U8(x) ((u8)(((x) > 255) ? 255 : (((x) < 0) ? 0 : (x))))", 0 },
+    { "#define SQR(x) ((x)*(x))", 0 },
+    { "#define COMPLEX_OP(a,b,c) (ADD(MUL((a),(b)), (c)))", 0 },
+    { "", 0 },
+    { "static u8 make_mod(u8 a, u8 b) {", 0 },
+    { "    return (u8)((a + b + 4) % 256);" MARK, 1 },
+    { "}", 0 },
+    { "", 0 },
+    { "static i8 make_signed_op(i8 a, i8 b) {", 0 },
+    { "    return (i8)(a - b);", 0 },
+    { "}", 0 },
+    { "", 0 },
+    { "static u8 mix_signed_unsigned(u8 ua, i8 ib) {", 0 },
+    { "    i32 tmp = (i32)ua + (i32)ib;" MARK, 1 },
+    { "    return (u8)tmp;", 0 },
+    { "}", 0 },
+    { "", 0 },
+    { "static u8 compare_and_select(u8 a, i8 b) {", 0 },
+    { "    int c = 0;", 0 },
+    { "    c = c + 3U;", 0 },
+    { "    (void)c;", 0 },
+    { "    if (a < b) {" MARK, 1 },
+    { "        return MAKE_U8(0);", 0 },
+    { "    } else {", 0 },
+    { "        return MAKE_U8(1);", 0 },
+    { "    }", 0 },
+    { "}", 0 },
+    { "", 0 },
+    { "typedef struct {", 0 },
+    { "    my_u8_t  a;", 0 },
+    { "    my_i8_t  b;", 0 },
+    { "    u16      c;", 0 },
+    { "    i16      d;", 0 },
+    { "} node_t;", 0 },
+    { "", 0 },
+    { "typedef node_t * node_ptr;", 0 },
+    { "", 0 },
+    { "#define NODE_SET_A(n, val) ((n).a = MAKE_U8(val))", 0 },
+    { "#define NODE_SET_B(n, val) ((n).b = MAKE_I8(val))", 0 },
+    { "", 0 },
+};
+
+/* scenario blocks, numbered as in example.c's main (21 is emitted by main) */
+static const tline_t s01[] = {
+    { "u8 r1 = mix_signed_unsigned(ua, ib);" MARK, 1 },
+    { "printf(\"r1: %u\\n\", r1);", 0 },
+    { "u8 r2 = compare_and_select(uc, id);" MARK, 1 },
+    { "printf(\"r2: %u\\n\", r2);", 0 },
+};
+static const tline_t s02[] = {
+    { "u8 r3 = (u8)(ua + (u8)id);" MARK, 1 },
+    { "printf(\"r3: %u\\n\", r3);", 0 },
+};
+static const tline_t s03[] = {
+    { "u8 r4 = CLAMP_U8((int)ua + (int)ib);" MARK, 1 },
+    { "printf(\"r4: %u\\n\", r4);", 0 },
+};
+static const tline_t s04[] = {
+    { "if ((u8)uw > (u8)sw) {" MARK, 1 },
+    { "    printf(\"uw > sw (as u8)\\n\");", 0 },
+    { "}", 0 },
+};
+static const tline_t s05[] = {
+    { "nodes[2].a = mix_signed_unsigned(nodes[2].a, nodes[2].b);" MARK, 1 },
+    { "printf(\"nodes[2].a: %u\\n\", nodes[2].a);", 0 },
+};
+static const tline_t s06[] = {
+    { "u8 r5 = MAKE_U8(COMPLEX_OP(ua, uc, ib));" MARK, 1 },
+    { "printf(\"r5: %u\\n\", r5);", 0 },
+};
+static const tline_t s07[] = {
+    { "for (int i = -5; i < 10; ++i) {", 0 },
+    { "    u8 v = MAKE_U8(i + ua);" MARK, 1 },
+    { "    if (v < ua) {" MARK, 1 },
+    { "        printf(\"v<ua: %d -> %u\\n\", i, v);", 0 },
+    { "    }", 0 },
+    { "}", 0 },
+};
+static const tline_t s08[] = {
+    { "u8 r6 = (u8)(ua >> 1);", 0 },
+    { "i8 r7 = (i8)(ib << 2);", 0 },
+    { "u8 r8 = (u8)((u32)ua | (u32)(i32)ib);" MARK, 1 },
+    { "printf(\"r6:%u r7:%d r8:%u\\n\", r6, r7, r8);", 0 },
+};
+static const tline_t s09[] = {
+    { "if ((i32)ua + (i32)ib < 0) {" MARK, 1 },
+    { "    printf(\"sum negative\\n\");", 0 },
+    { "} else {", 0 },
+    { "    printf(\"sum non-negative\\n\");", 0 },
+    { "}", 0 },
+};
+static const tline_t s10[] = {
+    { "u8 (*fp1)(u8, i8) = mix_signed_unsigned;", 0 },
+    { "u8 r9 = fp1(120, -200);" MARK, 1 },
+    { "printf(\"r9: %u\\n\", r9);", 0 },
+};
+static const tline_t s11[] = {
+    { "my_u8_t chain = MAKE_U8(10);", 0 },
+    { "my_i8_t chain2 = MAKE_I8(-20);", 0 },
+    { "chain = mix_signed_unsigned(chain, chain2);" MARK, 1 },
+    { "printf(\"chain: %u\\n\", chain);", 0 },
+};
+static const tline_t s12[] = {
+    { "for (int i = 0; i < 20; ++i) {", 0 },
+    { "    i8 s = (i8)(i - 10);", 0 },
+    { "    u8 t = (u8)(i * 15);", 0 },
+    { "    u8 z = (u8)(s + t);" MARK, 1 },
+    { "    (void)z;", 0 },
+    { "}", 0 },
+};
+static const tline_t s13[] = {
+    { "u8 buffer[32];", 0 },
+    { "memset(buffer, 0xFF, sizeof(buffer));", 0 },
+    { "i32 offset = -1;", 0 },
+    { "u8 *p = buffer + (size_t)offset;" MARK, 1 },
+    { "(void)p;", 0 },
+};
+static const tline_t s14[] = {
+    { "u8 acc = 0;", 0 },
+    { "acc = MAKE_U8(acc + ua + (u8)ib);" MARK, 1 },
+    { "acc = MAKE_U8(acc - (u8)id);" MARK, 1 },
+    { "acc = MAKE_U8(acc + (u8)nodes[5].b);" MARK, 1 },
+    { "(void)acc;", 0 },
+};
+static const tline_t s15[] = {
+    { "u8 a1 = SQR((u8)20);", 0 },
+    { "u8 a2 = CLAMP_U8((int)a1 + (int)nodes[1].b);" MARK, 1 },
+    { "printf(\"a1:%u a2:%u\\n\", a1, a2);", 0 },
+};
+static const tline_t s16[] = {
+    { "small_t st = 128;", 0 },
+    { "sbyte_t sb = -128;", 0 },
+    { "st = MAKE_U8(st + (u8)sb);" MARK, 1 },
+    { "printf(\"st:%u sb:%d\\n\", st, sb);", 0 },
+};
+static const tline_t s17[] = {
+    { "u8 tmp1 = make_mod(250, 10);" MARK, 1 },
+    { "i8 tmp2 = make_signed_op(-5, 3);", 0 },
+    { "printf(\"tmp1:%u tmp2:%d\\n\", tmp1, tmp2);", 0 },
+};
+static const tline_t s18[] = {
+    { "for (int i = 0; i < 10; ++i) {", 0 },
+    { "    NODE_SET_A(nodes[i], i * 25);", 0 },
+    { "    NODE_SET_B(nodes[i], i - 7);", 0 },
+    { "    nodes[i].a = mix_signed_unsigned(nodes[i].a, nodes[i].b);" MARK, 1 },
+    { "}", 0 },
+};
+static const tline_t s19[] = {
+    { "u32 bigu = 3000000000u;", 0 },
+    { "i32 bigs = -1000000000;", 0 },
+    { "if (bigu > (u32)bigs) {" MARK, 1 },
+    { "    printf(\"bigu > bigs as u32\\n\");", 0 },
+    { "}", 0 },
+};
+static const tline_t s20[] = {
+    { "u8 nm = MAKE_U8(CLAMP_U8(COMPLEX_OP(nodes[0].a, nodes[1].a, nodes[2].b)));" MARK, 1 },
+    { "printf(\"nm:%u\\n\", nm);", 0 },
+};
+
+#define SCENARIO(n) { "s" #n, s##n, sizeof(s##n) / sizeof(s##n[0]) }
+
+static const scenario_t scenarios[] = {
+    SCENARIO(01), SCENARIO(02), SCENARIO(03), SCENARIO(04), SCENARIO(05),
+    SCENARIO(06), SCENARIO(07), SCENARIO(08), SCENARIO(09), SCENARIO(10),
+    SCENARIO(11), SCENARIO(12), SCENARIO(13), SCENARIO(14), SCENARIO(15),
+    SCENARIO(16), SCENARIO(17), SCENARIO(18), SCENARIO(19), SCENARIO(20),
+};
+
+#define NSCENARIOS (sizeof(scenarios) / sizeof(scenarios[0]))
+
+/* lines a chunk function spends outside its scenario blocks */
+#define FN_HEAD_LINES 15
+#define FN_TAIL_LINES 3
+#define MAIN_FIXED_LINES 5
+#define MAX_BLOCKS 32
+
+static uint32_t next_rand(gen_t *g) {
+    /* 64-bit LCG (Knuth MMIX constants); top bits are the usable ones */
+    g->rng = g->rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (uint32_t)(g->rng >> 33);
+}
+
+static void emit(gen_t *g, const char *indent, const char *text, const char *site) {
+    fprintf(g->out, "%s%s\n", indent, text);
+    g->line++;
+    if (site != NULL) {
+        fprintf(g->manifest, "%s:%" PRIu64 ":%s\n", g->path, g->line, site);
+        g->sites++;
+    }
+}
+
+static void emit_lines(gen_t *g, const char *indent, const tline_t *lines, size_t count,
+                       const char *site) {
+    for (size_t i = 0; i < count; ++i) {
+        emit(g, indent, lines[i].text, lines[i].site ? site : NULL);
+    }
+}
+
+static size_t block_lines(const scenario_t *sc) {
+    return sc->count + 2; /* enclosing braces */
+}
+
+/* emits one function of scenario blocks; returns its line count */
+static uint64_t emit_function(gen_t *g, uint64_t index, uint64_t budget) {
+    char buf[128];
+    uint64_t start = g->line;
+    uint32_t blocks = 1 + next_rand(g) % MAX_BLOCKS;
+
+    snprintf(buf, sizeof(buf), "static void corpus_fn_%" PRIu64 "(void) {", index);
+    emit(g, "", buf, NULL);
+    snprintf(buf, sizeof(buf), "u8 ua = %u;", (unsigned)(next_rand(g) % 256));
+    emit(g, "    ", buf, NULL);
+    snprintf(buf, sizeof(buf), "i8 ib = %d;", (int)(next_rand(g) % 256) - 128);
+    emit(g, "    ", buf, NULL);
+    snprintf(buf, sizeof(buf), "u8 uc = %u;", (unsigned)(next_rand(g) % 256));
+    emit(g, "    ", buf, NULL);
+    snprintf(buf, sizeof(buf), "i8 id = %d;", (int)(next_rand(g) % 256) - 128);
+    emit(g, "    ", buf, NULL);
+    snprintf(buf, sizeof(buf), "u16 uw = %u;", (unsigned)(next_rand(g) % 65536));
+    emit(g, "    ", buf, NULL);
+    snprintf(buf, sizeof(buf), "i16 sw = %d;", (int)(next_rand(g) % 65536) - 32768);
+    emit(g, "    ", buf, NULL);
+    emit(g, "    ", "node_t nodes[10];", NULL);
+    emit(g, "    ", "for (int i = 0; i < 10; ++i) {", NULL);
+    emit(g, "    ", "    nodes[i].a = (u8)(i * 10);", NULL);
+    emit(g, "    ", "    nodes[i].b = (i8)(i - 5);", NULL);
+    emit(g, "    ", "    nodes[i].c = (u16)(i * 1000);", NULL);
+    emit(g, "    ", "    nodes[i].d = (i16)(i * -200);", NULL);
+    emit(g, "    ", "}", NULL);
+    emit(g, "", "", NULL);
+
+    for (uint32_t b = 0; b < blocks; ++b) {
+        const scenario_t *sc = &scenarios[next_rand(g) % NSCENARIOS];
+        uint64_t used = g->line - start;
+        if (b > 0 && used + block_lines(sc) + FN_TAIL_LINES > budget) {
+            break;
+        }
+        emit(g, "    ", "{", NULL);
+        emit_lines(g, "        ", sc->lines, sc->count, sc->id);
+        emit(g, "    ", "}", NULL);
+    }
+
+    emit(g, "    ", "(void)ua; (void)ib; (void)uc; (void)id; (void)uw; (void)sw;", NULL);
+    emit(g, "", "}", NULL);
+    emit(g, "", "", NULL);
+    return g->line - start;
+}
+
+static int parse_lines(const char *s, uint64_t *out) {
+    char *end = NULL;
+    unsigned long long v = strtoull(s, &end, 10);
+    if (end == s) {
+        return -1;
+    }
+    if (*end == 'k' || *end == 'K') {
+        v *= 1000ULL;
+        end++;
+    } else if (*end == 'm' || *end == 'M') {
+        v *= 1000000ULL;
+        end++;
+    }
+    if (*end != '\0' || v == 0) {
+        return -1;
+    }
+    *out = (uint64_t)v;
+    return 0;
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-n lines] [-s seed] [-o out.c] [-m manifest.txt]"
+            " [-N name]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    uint64_t target = 10000;
+    uint64_t seed = 1;
+    const char *out_path = "corpus.c";
+    const char *manifest_path = NULL;
+    const char *name = NULL;
+    char manifest_buf[4096];
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            if (parse_lines(argv[++i], &target) != 0) {
+                fprintf(stderr, "gen_corpus: bad line count '%s'\n", argv[i]);
+                return 2;
+            }
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            manifest_path = argv[++i];
+        } else if (strcmp(argv[i], "-N") == 0 && i + 1 < argc) {
+            name = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (manifest_path == NULL) {
+        snprintf(manifest_buf, sizeof(manifest_buf), "%s.manifest", out_path);
+        manifest_path = manifest_buf;
+    }
+
+    gen_t g;
+    memset(&g, 0, sizeof(g));
+    g.path = name ? name : out_path;
+    g.rng = seed;
+    g.out = fopen(out_path, "w");
+    if (g.out == NULL) {
+        perror(out_path);
+        return 1;
+    }
+    g.manifest = fopen(manifest_path, "w");
+    if (g.manifest == NULL) {
+        perror(manifest_path);
+        fclose(g.out);
+        return 1;
+    }
+
+    emit_lines(&g, "", prelude, sizeof(prelude) / sizeof(prelude[0]), "helper");
+
+    /* keep room for main: one call per function plus its fixed lines */
+    uint64_t nfn = 0;
+    for (;;) {
+        uint64_t reserved = g.line + nfn + MAIN_FIXED_LINES;
+        if (reserved + FN_HEAD_LINES + FN_TAIL_LINES + 4 >= target) {
+            break;
+        }
+        uint64_t budget = target - reserved - 1; /* this function's own call in main */
+        emit_function(&g, nfn, budget);
+        nfn++;
+    }
+
+    emit(&g, "", "int main(void) {", NULL);
+    for (uint64_t i = 0; i < nfn; ++i) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "corpus_fn_%" PRIu64 "();", i);
+        emit(&g, "    ", buf, NULL);
+    }
+    emit(&g, "    ", "/* 21: final summary prints */", NULL);
+    char summary[96];
+    snprintf(summary, sizeof(summary), "printf(\"Final values: %%d functions\\n\", %" PRIu64 ");", nfn);
+    emit(&g, "    ", summary, NULL);
+    emit(&g, "    ", "return 0;", NULL);
+    emit(&g, "", "}", NULL);
+
+    int rc = 0;
+    if (fclose(g.out) != 0) {
+        perror(out_path);
+        rc = 1;
+    }
+    if (fclose(g.manifest) != 0) {
+        perror(manifest_path);
+        rc = 1;
+    }
+    fprintf(stderr, "gen_corpus: %s: %" PRIu64 " lines, %" PRIu64 " functions, %" PRIu64
+            " expected sites -> %s\n", out_path, g.line, nfn, g.sites, manifest_path);
+    return rc;
+}
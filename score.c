@@ -0,0 +1,311 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+  score.c
+  - precision/recall of analyzer findings against the inline
+    "unsigned不一致" markers of example.c and gen_corpus outputs
+  - one streaming pass per source file and one over the findings,
+    no parsing, so it is cheap enough to run after every benchmark
+  - writes per-file and total scores plus every miss and spurious
+    finding to test_output.txt
+
+  build: cc -O2 -o score score.c
+  usage: score [-o test_output.txt] [-p min_precision] [-r min_recall]
+               findings.txt source.c [source.c ...]
+
+  findings.txt: one "path:line[:anything]" per finding; gen_corpus
+  manifests use the same layout. A marker counts only where a block
+  comment starts with it; a marker comment alone on its line refers to
+  the next line that has code. An empty findings list against expected
+  sites scores precision 0, so -p alone already rejects a silent analyzer.
+
+  exit status: 0 ok, 1 below -p/-r thresholds, 2 usage or input error
+*/
+
+#define MARKER "unsigned不一致"
+#define MAX_SOURCES 256
+
+typedef struct {
+    uint64_t *v;
+    size_t    len;
+    size_t    cap;
+} lines_t;
+
+typedef struct {
+    const char *path;
+    lines_t     expected;
+    lines_t     found;
+} source_t;
+
+typedef struct {
+    uint64_t tp;
+    uint64_t fp;
+    uint64_t fn;
+} counts_t;
+
+static void lines_push(lines_t *l, uint64_t line) {
+    if (l->len == l->cap) {
+        l->cap = l->cap ? l->cap * 2 : 256;
+        l->v = realloc(l->v, l->cap * sizeof(uint64_t));
+        if (l->v == NULL) {
+            fprintf(stderr, "score: out of memory\n");
+            exit(2);
+        }
+    }
+    l->v[l->len++] = line;
+}
+
+static int cmp_u64(const void *pa, const void *pb) {
+    uint64_t a = *(const uint64_t *)pa;
+    uint64_t b = *(const uint64_t *)pb;
+    return a < b ? -1 : (a > b);
+}
+
+static void lines_sort_unique(lines_t *l) {
+    size_t n = 0;
+    qsort(l->v, l->len, sizeof(uint64_t), cmp_u64);
+    for (size_t i = 0; i < l->len; ++i) {
+        if (n == 0 || l->v[n - 1] != l->v[i]) {
+            l->v[n++] = l->v[i];
+        }
+    }
+    l->len = n;
+}
+
+static const char *skip_ws(const char *s) {
+    while (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n') {
+        s++;
+    }
+    return s;
+}
+
+static int blank_line(const char *line) {
+    return *skip_ws(line) == '\0';
+}
+
+/* 1 if the line opens a comment with the marker, 2 if that comment is all it holds */
+static int marker_kind(const char *line) {
+    for (const char *p = strstr(line, "/*"); p != NULL; p = strstr(p + 2, "/*")) {
+        if (strncmp(skip_ws(p + 2), MARKER, sizeof(MARKER) - 1) == 0) {
+            const char *close = strstr(p + 2, "*/");
+            int alone = skip_ws(line) == p && close != NULL && blank_line(close + 2);
+            return alone ? 2 : 1;
+        }
+    }
+    return 0;
+}
+
+static int extract_markers(source_t *src) {
+    FILE *f = fopen(src->path, "r");
+    if (f == NULL) {
+        perror(src->path);
+        return -1;
+    }
+    char *line = NULL;
+    size_t cap = 0;
+    uint64_t lineno = 0;
+    uint64_t pending = 0; /* standalone markers waiting for their code line */
+    while (getline(&line, &cap, f) != -1) {
+        lineno++;
+        int kind = marker_kind(line);
+        if (kind == 2) {
+            pending++;
+            continue;
+        }
+        if (pending > 0 && !blank_line(line) && strncmp(skip_ws(line), "/*", 2) != 0) {
+            lines_push(&src->expected, lineno);
+            pending = 0;
+        }
+        if (kind == 1) {
+            lines_push(&src->expected, lineno);
+        }
+    }
+    free(line);
+    fclose(f);
+    lines_sort_unique(&src->expected);
+    return 0;
+}
+
+static const char *strip_dot(const char *path) {
+    while (path[0] == '.' && path[1] == '/') {
+        path += 2;
+    }
+    return path;
+}
+
+static source_t *find_source(source_t *srcs, size_t n, const char *path) {
+    path = strip_dot(path);
+    for (size_t i = 0; i < n; ++i) {
+        if (strcmp(strip_dot(srcs[i].path), path) == 0) {
+            return &srcs[i];
+        }
+    }
+    return NULL;
+}
+
+/* findings for files that are not scored are all spurious; kept as text */
+static int load_findings(const char *path, source_t *srcs, size_t n, FILE *out,
+                         counts_t *unscored) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    char *line = NULL;
+    size_t cap = 0;
+    const char *last_path = NULL;
+    source_t *last = NULL;
+    while (getline(&line, &cap, f) != -1) {
+        char *colon = strchr(line, ':');
+        if (line[0] == '#' || colon == NULL) {
+            continue;
+        }
+        *colon = '\0';
+        char *end = NULL;
+        unsigned long long lineno = strtoull(colon + 1, &end, 10);
+        if (end == colon + 1) {
+            continue;
+        }
+        if (last_path == NULL || strcmp(last_path, line) != 0) {
+            last = find_source(srcs, n, line);
+            last_path = last ? last->path : NULL;
+        }
+        if (last == NULL) {
+            fprintf(out, "spurious=%s:%llu\n", line, lineno);
+            unscored->fp++;
+            continue;
+        }
+        lines_push(&last->found, (uint64_t)lineno);
+    }
+    free(line);
+    fclose(f);
+    for (size_t i = 0; i < n; ++i) {
+        lines_sort_unique(&srcs[i].found);
+    }
+    return 0;
+}
+
+static counts_t compare(const source_t *src, FILE *out) {
+    counts_t c = { 0, 0, 0 };
+    size_t e = 0;
+    size_t f = 0;
+    while (e < src->expected.len || f < src->found.len) {
+        if (f == src->found.len ||
+            (e < src->expected.len && src->expected.v[e] < src->found.v[f])) {
+            fprintf(out, "miss=%s:%" PRIu64 "\n", src->path, src->expected.v[e++]);
+            c.fn++;
+        } else if (e == src->expected.len || src->found.v[f] < src->expected.v[e]) {
+            fprintf(out, "spurious=%s:%" PRIu64 "\n", src->path, src->found.v[f++]);
+            c.fp++;
+        } else {
+            c.tp++;
+            e++;
+            f++;
+        }
+    }
+    return c;
+}
+
+/* no findings at all scores 0 when sites were expected: a silent analyzer fails -p */
+static double precision(counts_t c) {
+    if (c.tp + c.fp == 0) {
+        return c.fn > 0 ? 0.0 : 1.0;
+    }
+    return (double)c.tp / (double)(c.tp + c.fp);
+}
+
+static double recall(counts_t c) {
+    return c.tp + c.fn ? (double)c.tp / (double)(c.tp + c.fn) : 1.0;
+}
+
+static void write_score(FILE *out, const char *label, const char *name, counts_t c) {
+    double p = precision(c);
+    double r = recall(c);
+    double f1 = (p + r) > 0.0 ? 2.0 * p * r / (p + r) : 0.0;
+    fprintf(out, "%s=%s expected=%" PRIu64 " found=%" PRIu64 " tp=%" PRIu64 " fp=%" PRIu64
+            " fn=%" PRIu64 " precision=%.4f recall=%.4f f1=%.4f\n", label, name,
+            c.tp + c.fn, c.tp + c.fp, c.tp, c.fp, c.fn, p, r, f1);
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-o out] [-p min_precision] [-r min_recall]"
+            " findings.txt source.c [source.c ...]\n", argv0);
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = "test_output.txt";
+    const char *findings = NULL;
+    double min_p = 0.0;
+    double min_r = 0.0;
+    static source_t srcs[MAX_SOURCES];
+    size_t nsrcs = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            min_p = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            min_r = strtod(argv[++i], NULL);
+        } else if (findings == NULL) {
+            findings = argv[i];
+        } else if (nsrcs < MAX_SOURCES) {
+            srcs[nsrcs++].path = argv[i];
+        } else {
+            fprintf(stderr, "score: more than %d sources\n", MAX_SOURCES);
+            return 2;
+        }
+    }
+    if (findings == NULL || nsrcs == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    for (size_t i = 0; i < nsrcs; ++i) {
+        if (extract_markers(&srcs[i]) != 0) {
+            return 2;
+        }
+    }
+
+    FILE *out = fopen(out_path, "w");
+    if (out == NULL) {
+        perror(out_path);
+        return 2;
+    }
+    fprintf(out, "# score format=1 findings=%s\n", findings);
+
+    counts_t total = { 0, 0, 0 };
+    if (load_findings(findings, srcs, nsrcs, out, &total) != 0) {
+        fclose(out);
+        return 2;
+    }
+    for (size_t i = 0; i < nsrcs; ++i) {
+        counts_t c = compare(&srcs[i], out);
+        write_score(out, "file", srcs[i].path, c);
+        total.tp += c.tp;
+        total.fp += c.fp;
+        total.fn += c.fn;
+    }
+    write_score(out, "total", "all", total);
+
+    double p = precision(total);
+    double r = recall(total);
+    int rc = (p < min_p || r < min_r) ? 1 : 0;
+    if (fclose(out) != 0) {
+        perror(out_path);
+        rc = 2;
+    }
+    fprintf(stderr, "score: precision=%.4f recall=%.4f -> %s\n", p, r, out_path);
+
+    for (size_t i = 0; i < nsrcs; ++i) {
+        free(srcs[i].expected.v);
+        free(srcs[i].found.v);
+    }
+    return rc;
+}
@@ -0,0 +1,127 @@
+#!/bin/sh
+#
+# test_apply_fixes.sh
+# - regression cases for apply_fixes: conflict, duplicate, insertion,
+#   end-of-file, empty-source and line-join rules
+# - every case checks the rewritten output, the exit status, and that
+#   patch(1) applied to the original with the generated diff reproduces
+#   that output
+#
+# usage: test_apply_fixes.sh [-d dir]
+#   CC (default cc) and CFLAGS (default -O1 -Wall) are taken from the
+#   environment; the tool and case files go to _gate_build/test_apply_fixes
+#
+# exit status: 0 all cases pass, 1 otherwise
+
+set -u
+
+dir=_gate_build/test_apply_fixes
+while getopts d: opt; do
+    case $opt in
+        d) dir=$OPTARG ;;
+        *) echo "usage: $0 [-d dir]" >&2; exit 1 ;;
+    esac
+done
+
+src=$(dirname "$0")/apply_fixes.c
+cc=${CC:-cc}
+cflags=${CFLAGS:--O1 -Wall}
+mkdir -p "$dir" || exit 1
+# shellcheck disable=SC2086
+$cc $cflags -o "$dir/apply_fixes" "$src" || exit 1
+
+failed=0
+cases=0
+
+# check <name> <expected status>: uses $dir/<name>.{c,fixes,want}
+check() {
+    cases=$((cases + 1))
+    base=$dir/$1
+    "$dir/apply_fixes" -o "$base.out" -d "$base.patch" "$base.c" "$base.fixes" 2> "$base.err"
+    status=$?
+    if [ $status -ne "$2" ]; then
+        echo "FAIL $1: exit status $status, want $2" >&2
+        cat "$base.err" >&2
+        failed=$((failed + 1))
+        return
+    fi
+    if ! cmp -s "$base.out" "$base.want"; then
+        echo "FAIL $1: output differs" >&2
+        diff -u "$base.want" "$base.out" >&2
+        failed=$((failed + 1))
+        return
+    fi
+    cp "$base.c" "$base.patched"
+    if [ -s "$base.patch" ]; then
+        if ! patch -s "$base.patched" "$base.patch" > /dev/null 2>&1; then
+            echo "FAIL $1: diff does not apply" >&2
+            cat "$base.patch" >&2
+            failed=$((failed + 1))
+            return
+        fi
+    fi
+    if ! cmp -s "$base.patched" "$base.want"; then
+        echo "FAIL $1: applying the diff does not reproduce the output" >&2
+        failed=$((failed + 1))
+        return
+    fi
+    echo "ok   $1"
+}
+
+# insertion into an empty source: one "@@ -0,0 +1,N @@" hunk
+: > "$dir/empty_source.c"
+printf '1:1-1:1\thello\\nworld\\n\n' > "$dir/empty_source.fixes"
+printf 'hello\nworld\n' > "$dir/empty_source.want"
+check empty_source 0
+
+# identical fixes reported twice are applied once
+printf 'u8 r3 = (u8)(ua + (u8)id);\n' > "$dir/duplicate.c"
+printf '1:14-1:25\t(int)ua + (int)(u8)id\n1:14-1:25\t(int)ua + (int)(u8)id\n' \
+    > "$dir/duplicate.fixes"
+printf 'u8 r3 = (u8)((int)ua + (int)(u8)id);\n' > "$dir/duplicate.want"
+check duplicate 0
+
+# a fix nested in another one is skipped; the outer span wins
+printf 'u8 nm = MAKE_U8(CLAMP_U8(x));\n' > "$dir/nested_conflict.c"
+printf '1:17-1:28\tCLAMP_U8((int)x)\n1:26-1:27\ty\n' > "$dir/nested_conflict.fixes"
+printf 'u8 nm = MAKE_U8(CLAMP_U8((int)x));\n' > "$dir/nested_conflict.want"
+check nested_conflict 1
+
+# two different insertions at one offset have no defined order
+printf 'a < b\n' > "$dir/insert_conflict.c"
+printf '1:1-1:1\t(int)\n1:1-1:1\t(unsigned)\n' > "$dir/insert_conflict.fixes"
+printf '(int)a < b\n' > "$dir/insert_conflict.want"
+check insert_conflict 1
+
+# an insertion right after a replaced span is not a conflict
+printf 'a < b\n' > "$dir/adjacent.c"
+printf '1:1-1:2\t(int)a\n1:2-1:2\t /* fixed */\n' > "$dir/adjacent.fixes"
+printf '(int)a /* fixed */ < b\n' > "$dir/adjacent.want"
+check adjacent 0
+
+# appending to a last line without a trailing newline
+printf 'int x;\nreturn 0;\n}' > "$dir/eof_no_newline.c"
+printf '3:2-3:2\t\\n/* end */\n' > "$dir/eof_no_newline.fixes"
+printf 'int x;\nreturn 0;\n}\n/* end */' > "$dir/eof_no_newline.want"
+check eof_no_newline 0
+
+# deleting whole lines and editing far apart: two hunks, shifted line numbers
+i=1
+: > "$dir/hunks.c"
+while [ $i -le 20 ]; do
+    echo "line $i" >> "$dir/hunks.c"
+    i=$((i + 1))
+done
+printf '2:1-4:1\t\n18:6-18:8\teighteen\n' > "$dir/hunks.fixes"
+sed -e '2,3d' -e 's/^line 18$/line eighteen/' "$dir/hunks.c" > "$dir/hunks.want"
+check hunks 0
+
+# a span that ends at a line start without a newline in the replacement
+# joins the next line, which must be part of the rewritten block
+printf 'a\nb\nc\n' > "$dir/line_join.c"
+printf '1:2-2:1\t \n' > "$dir/line_join.fixes"
+printf 'a b\nc\n' > "$dir/line_join.want"
+check line_join 0
+
+echo "$((cases - failed))/$cases cases passed"
+[ $failed -eq 0 ]
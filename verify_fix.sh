@@ -0,0 +1,159 @@
+#!/bin/sh
+#
+# verify_fix.sh
+# - differential check of a fixer rewrite: builds the original and the
+#   fixed source in parallel, runs both and diffs their output
+#   (the printf lines r1..r9, "Final values ..." and the exit status)
+# - binaries and run outputs are cached under _gate_build/verify by a
+#   hash of the compiler's --version output, flags and source, so
+#   re-verifying an unchanged file costs two cache lookups; runs that hit
+#   the timeout are not cached
+# - temp files carry the shell's pid, so concurrent verifications (one per
+#   file from a pre-commit hook) can share the cache
+#
+# usage: verify_fix.sh [-d dir] original.c fixed.c
+#   CC (default cc), CFLAGS (default -O1 -w) and TIMEOUT (seconds,
+#   default 10) are taken from the environment
+#
+# exit status: 0 same behavior, 1 behavior differs,
+#              2 build, hash, timeout, cache or usage error
+
+set -u
+
+dir=_gate_build/verify
+while getopts d: opt; do
+    case $opt in
+        d) dir=$OPTARG ;;
+        *) echo "usage: $0 [-d dir] original.c fixed.c" >&2; exit 2 ;;
+    esac
+done
+shift $((OPTIND - 1))
+if [ $# -ne 2 ]; then
+    echo "usage: $0 [-d dir] original.c fixed.c" >&2
+    exit 2
+fi
+
+orig=$1
+fixed=$2
+cc=${CC:-cc}
+cflags=${CFLAGS:--O1 -w}
+timeout=${TIMEOUT:-10}
+
+mkdir -p "$dir" || exit 2
+
+if command -v sha256sum > /dev/null 2>&1; then
+    hasher=sha256sum
+elif command -v shasum > /dev/null 2>&1; then
+    hasher="shasum -a 256"
+else
+    echo "verify_fix: need sha256sum or shasum to key the build cache" >&2
+    exit 2
+fi
+
+# the compiler's identity, not its name: an upgraded cc must not reuse old binaries
+# shellcheck disable=SC2086
+if ! ccid=$($cc --version 2>&1); then
+    echo "verify_fix: $cc --version failed:" >&2
+    printf '%s\n' "$ccid" | head -n 5 >&2
+    exit 2
+fi
+
+key() {
+    # shellcheck disable=SC2086
+    { printf '%s\n%s\n' "$ccid" "$cflags"; cat "$1"; } | $hasher | cut -c1-16
+}
+
+# build <source> <key>: compiles into $dir/<key> unless already cached;
+# compiler messages go to $dir/<key>.$$.log
+build() {
+    [ -x "$dir/$2" ] && return 0
+    tmp=$dir/$2.$$.tmp
+    # shellcheck disable=SC2086
+    if $cc $cflags -o "$tmp" "$1" 2> "$dir/$2.$$.log" && mv -f "$tmp" "$dir/$2"; then
+        rm -f "$dir/$2.$$.log"
+    else
+        rm -f "$tmp"
+        return 1
+    fi
+}
+
+# run <key>: caches stdout plus the exit status as $dir/<key>.out;
+# returns 3 without caching anything when timeout(1) killed the run,
+# 1 when the result could not be stored
+run() {
+    [ -f "$dir/$1.out" ] && return 0
+    tmp=$dir/$1.$$.tmp
+    if command -v timeout > /dev/null 2>&1; then
+        timeout "$timeout" "$dir/$1" > "$tmp" 2> /dev/null
+        status=$?
+        if [ $status -eq 124 ]; then
+            rm -f "$tmp"
+            return 3
+        fi
+    else
+        "$dir/$1" > "$tmp" 2> /dev/null
+        status=$?
+    fi
+    if ! { echo "exit status: $status" >> "$tmp" && mv -f "$tmp" "$dir/$1.out"; }; then
+        rm -f "$tmp"
+        return 1
+    fi
+}
+
+for f in "$orig" "$fixed"; do
+    if [ ! -f "$f" ]; then
+        echo "verify_fix: $f: no such file" >&2
+        exit 2
+    fi
+done
+
+if cmp -s "$orig" "$fixed"; then
+    echo "verify_fix: $fixed is identical to $orig"
+    exit 0
+fi
+
+ko=$(key "$orig")
+kf=$(key "$fixed")
+for k in "$ko" "$kf"; do
+    case $k in
+        ????????????????) ;;
+        *) echo "verify_fix: could not hash the sources with $hasher" >&2; exit 2 ;;
+    esac
+done
+
+build "$orig" "$ko" &
+po=$!
+build "$fixed" "$kf" &
+pf=$!
+wait $po; so=$?
+wait $pf; sf=$?
+if [ $so -ne 0 ] || [ $sf -ne 0 ]; then
+    [ $so -ne 0 ] && { echo "verify_fix: $orig does not build:" >&2; head -n 20 "$dir/$ko.$$.log" >&2; }
+    [ $sf -ne 0 ] && { echo "verify_fix: $fixed does not build:" >&2; head -n 20 "$dir/$kf.$$.log" >&2; }
+    rm -f "$dir/$ko.$$.log" "$dir/$kf.$$.log"
+    exit 2
+fi
+
+run "$ko" &
+po=$!
+run "$kf" &
+pf=$!
+wait $po; so=$?
+wait $pf; sf=$?
+if [ $so -ne 0 ] || [ $sf -ne 0 ]; then
+    for r in "$orig:$so" "$fixed:$sf"; do
+        case $r in
+            *:0) ;;
+            *:3) echo "verify_fix: ${r%:*} timed out after ${timeout}s" >&2 ;;
+            *) echo "verify_fix: could not store the run of ${r%:*} in $dir" >&2 ;;
+        esac
+    done
+    exit 2
+fi
+
+if diff -u --label "$orig" --label "$fixed" "$dir/$ko.out" "$dir/$kf.out"; then
+    echo "verify_fix: $fixed behaves like $orig ($(wc -l < "$dir/$ko.out") output lines)"
+    exit 0
+fi
+echo "verify_fix: $fixed changes the behavior of $orig" >&2
+exit 1